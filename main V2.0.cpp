@@ -1,185 +1,2417 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <sys/stat.h>
+#ifdef USE_SQLITE
+#include <sqlite3.h>
+#endif
 
-#define MAX_STUDENTS 100
+#define MAX_STUDENTS 5000 // Room for a full admission intake
 #define MAX_NAME 50
 #define MAX_ID 20
-#define MAX_RECORDS 200   
+#define INITIAL_RECORDS 16 // First record block size; blocks double when full
 #define FILENAME "attendance_data.csv" // The file Excel will open
+#define DB_FILENAME "attendance_data.db" // Used instead with --sqlite
+#define PAGE_SIZE 20      // Rows shown per page in listings
+#define REJECTS_FILE "import_rejects.csv" // Rows a roster import could not accept
+#define REPORT_FILE "attendance_report.csv"
+#define ARENA_CHUNK_SIZE (1 << 20) // Bytes per memory pool chunk
+#define CALENDAR_FILE "academic_calendar.txt" // Optional term dates and holidays
+#define MAX_HOLIDAYS 100
+#define DAY_INVALID -1    // Day number of a date that failed validation
+#define DAY_MAX 2932896   // Day number of 9999-12-31
+#define ALERTS_FILE "alerts_outbox.csv" // Advisor alerts waiting to be sent
+#define MAX_LINE 256      // Longest CSV row the loader accepts
+#define INDEX_MAGIC "ATMSIDX3" // First bytes of a data file's ".idx" companion
 
 // Structure to store attendance entries
 typedef struct {
     char date[15];
+    int day;          // days since 1970-01-01, DAY_INVALID for a bad date
     char status[10];  // "Present" or "Absent"
+    char saved;       // 1 once the row is in the data file
 } AttendanceRecord;
 
+// Heap block holding a student's records. Snapshots share blocks with the
+// live data; a shared block is copied before any existing record moves.
+typedef struct {
+    int refs;                    // owners: the student plus any snapshots
+    int capacity;
+    AttendanceRecord records[1]; // allocated with room for capacity records
+} RecordBlock;
+
 // Structure to store a student's whole information
 typedef struct {
     char name[MAX_NAME];
     char id[MAX_ID];
-    AttendanceRecord attendance[MAX_RECORDS];
+    RecordBlock *block;          // NULL until the first record
+    AttendanceRecord *attendance; // block->records, kept in date order
     int attendanceCount;   
+    int presentCount;      // cached total, so summaries never rescan records
+    int absentStreak;      // absences since the latest Present, by date
+    int alertsActive;      // bit per alert rule that has fired and not cleared
+    int inFile;            // 1 if the data file has at least one row for this student
+    int dirty;             // 1 if some change is not saved yet
+    long historyOffset;    // where this student's older rows start in historySource (0 once read)
+    int unloadedCount;     // older records still on disk, not in attendance[] yet
+    int unloadedPresent;
+    int unloadedStreak;    // absences at the end of those older records
 } Student;
 
-Student students[MAX_STUDENTS];
-int studentCount = 0;
+Student students[MAX_STUDENTS];
+int studentCount = 0;
+
+const char *dataFile = FILENAME; // FILENAME, or DB_FILENAME for the SQLite backend
+
+// Where students and records are persisted. loadData(), saveData() and
+// saveAllData() go through the selected backend.
+typedef struct {
+    const char *name;
+    void (*load)();          // fill students[] from dataFile
+    void (*saveAll)();       // write every student and record
+    void (*saveChanges)();   // write only what the dirty students changed
+    void (*close)();         // release the backend, may be NULL
+} StorageBackend;
+
+// Incremental saving: only students on the dirty list are written, and their
+// new rows are appended to dataFile instead of rewriting the whole file.
+int dirtyList[MAX_STUDENTS];
+int dirtyCount = 0;
+int fileSynced = 0;     // 1 if dataFile matches the loaded/saved data
+int fragments = 0;      // student row groups split across the file by appends
+int indexMissing = 0;   // 1 after a full scan: exit rewrites the file to build the index
+
+// Lazy history: a full CSV save writes rows before historyCutoff first, one
+// group per student, and records where each group starts in "<dataFile>.idx".
+// Startup reads the index and only the rows after the history section; a
+// student's older rows are read the first time something needs them.
+typedef struct {
+    char magic[8];
+    long dataSize;         // CSV size when the index was last updated
+    long long modified;    // CSV modification time then
+    long currentOffset;    // first byte after the history section
+    int cutoffDay;
+    int studentCount;
+    int invalidDateRows;   // rows with an invalid date, all in the history section
+    int fragments;         // row groups appended since the full save
+    unsigned tailHash;     // hash of the bytes just before dataSize
+} IndexHeader;
+// The index is trusted only while the CSV's size, modification time and
+// tail hash are exactly as recorded. The program's own appends update them.
+
+typedef struct {
+    char id[MAX_ID];
+    char name[MAX_NAME];
+    long historyOffset;
+    int historyCount;
+    int historyPresent;
+    int historyStreak;
+} IndexEntry;
+
+char historySource[256] = "";      // file the unloaded records are read from
+long historyEnd = 0;               // end of the history section in historySource
+int historyCutoff = DAY_INVALID;   // records before this day may be unloaded
+int unloadedStudents = 0;          // students with records still on disk
+
+// Read-only view of one student inside a snapshot
+typedef struct {
+    const Student *student;      // ID and name never change after creation
+    RecordBlock *block;
+    int recordCount;
+    int presentCount;
+    int unloadedCount;           // older records not in block, counted in totals only
+    int unloadedPresent;
+} StudentView;
+
+// Point-in-time copy of the student table for reports. Taking one copies
+// a pointer and two counts per student, never the records themselves.
+typedef struct {
+    int version;
+    int count;
+    StudentView *views;
+} Snapshot;
+
+int dataVersion = 0;    // bumped by every change to the student table
+int invalidDateRows = 0; // rows loaded with a date that is not a real date
+int unreadableRows = 0;  // rows skipped by the loader (too long, malformed or too wide)
+long loadedRows = 0;     // rows the loader took in; with unreadableRows, every row read
+
+// Term dates and class days from CALENDAR_FILE; without it every day counts
+typedef struct {
+    int termStart;               // day numbers, DAY_INVALID if not set
+    int termEnd;
+    int classDays;               // weekday bit mask, bit 0 = Sunday
+    int holidays[MAX_HOLIDAYS];  // sorted class days with no class
+    int holidayCount;
+} AcademicCalendar;
+
+AcademicCalendar calendar = { DAY_INVALID, DAY_INVALID, 0x7F, {0}, 0 };
+
+// Alert rules checked on every mark against each student's running totals
+#define RULE_BELOW_PERCENT 1   // attendance under threshold %
+#define RULE_ABSENT_STREAK 2   // threshold consecutive absences
+
+typedef struct {
+    int type;
+    int threshold;
+    int minClasses;        // records needed before a percentage rule applies
+} AlertRule;
+
+AlertRule alertRules[] = {
+    { RULE_BELOW_PERCENT, 75, 10 },
+    { RULE_ABSENT_STREAK, 3, 0 },
+};
+int alertRuleCount = sizeof(alertRules) / sizeof(alertRules[0]);
+int liveSnapshots = 0;
+
+// Memory pool for record blocks: large chunks handed out by bumping a pointer.
+// Blocks are never freed one by one; resetData() rewinds the whole pool.
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    size_t size;
+    size_t used;
+    double data[1];       // double keeps handed-out blocks aligned
+} ArenaChunk;
+
+ArenaChunk *arenaHead = NULL;
+ArenaChunk *arenaTail = NULL;
+ArenaChunk *arenaCurrent = NULL;
+int useArena = 1;       // 0 = one malloc per block (for comparison)
+long allocCount = 0;    // calls to malloc made for record storage
+
+// Sorted directory: positions into students[], kept ordered on every insert
+int idIndex[MAX_STUDENTS];    // ordered by ID
+int nameIndex[MAX_STUDENTS];  // ordered by name (case-insensitive), equal names in insertion order
+
+// Function prototypes
+void addStudent();
+void markAttendance();
+void viewAllStudents();
+void viewStudentAttendance();
+void searchStudents();
+void importStudents();
+int importRoster(const char *path, int *rejected);
+int isValidStudentId(const char *id);
+void clearScreen();
+void pauseProgram();
+void saveData();
+void saveAllData();
+void loadData();
+void closeStorage();
+void csvSaveChanges();
+void csvSaveAll();
+void csvLoad();
+void markAllSaved();
+void finishLoad();
+int appendDirtyStudents();
+void markDirty(int studentIdx);
+long generateData(long rows);
+void benchmarkStorage(int marks);
+int readLine(FILE *fp, char *line, int size, int *terminated);
+int defaultHistoryCutoff();
+void indexPath(char *path);
+unsigned hashFileTail(const char *path, long size);
+int stampIndex(IndexHeader *header);
+int readIndexHeader(FILE *fp, IndexHeader *header);
+int writeIndex(IndexEntry *entries, long dataSize, long currentOffset, int cutoffDay, int invalidRows);
+long loadIndex();
+int loadHistory(Student *s, FILE *fp);
+int rescanHistory();
+int ensureHistory(Student *s);
+int ensureAllHistory();
+int totalRecords(Student *s);
+int totalPresent(Student *s);
+int sameFiles(const char *a, const char *b);
+int roundTrip(const char *source, const char *first, const char *second);
+long countDataRows(const char *path);
+long countRecords();
+void removeDataFile(const char *path);
+void stressTest(long rows);
+int createStudent(const char *id, const char *name);
+int findStudentIndex(char *id);
+int compareNoCase(const char *a, const char *b, int len);
+int compareDirectoryKey(int studentIdx, const char *key, int len, int byName);
+int directoryBound(int *index, const char *key, int len, int byName, int upper);
+void directoryInsert(int studentIdx);
+int findPrefixRange(const char *prefix, int byName, int *first);
+int findIdRange(const char *fromId, const char *toId, int *first);
+void printStudentPages(int *index, int first, int count);
+int addRecord(Student *s, const char *date, const char *status);
+int findRecordBound(AttendanceRecord *records, int count, int day, int upper);
+int parseDate(const char *text);
+int weekday(int day);
+int isClassDay(int day);
+int classDayIndex(int day);
+void loadCalendar();
+int readDateRange(int *fromDay, int *toDay);
+void printRecordWindow(Student *s, int from, int to);
+RecordBlock *newRecordBlock(int capacity);
+void releaseRecordBlock(RecordBlock *block);
+void detachRecords(Student *s, int capacity);
+void *arenaAlloc(size_t bytes);
+void arenaReset();
+int resetData();
+void benchmarkLoad(int rounds);
+Snapshot *takeSnapshot();
+void releaseSnapshot(Snapshot *snap);
+int writeReport(Snapshot *snap, int fromDay, int toDay, const char *path);
+void attendanceReport();
+int ruleTriggered(Student *s, AlertRule *rule);
+void updateStreak(Student *s, int pos);
+void evaluateAlerts(int studentIdx, const char *date);
+void armAlerts(Student *s);
+
+StorageBackend csvStorage = { "CSV", csvLoad, csvSaveAll, csvSaveChanges, NULL };
+StorageBackend *storage = &csvStorage;
+
+#ifdef USE_SQLITE
+sqlite3 *db = NULL;
+char dbPath[256] = "";      // file the open connection belongs to
+sqlite3_stmt *insertStudentStmt = NULL;
+sqlite3_stmt *insertRecordStmt = NULL;
+
+int sqliteOpen();
+void sqliteClose();
+int sqliteExec(const char *sql);
+void sqliteLoad();
+void sqliteSaveAll();
+void sqliteSaveChanges();
+int sqliteInsertStudent(Student *s);
+int sqliteInsertRecord(Student *s, AttendanceRecord *r);
+int sqliteReport(int fromDay, int toDay, const char *path);
+void removeDatabase(const char *path);
+
+StorageBackend sqliteStorage = { "SQLite", sqliteLoad, sqliteSaveAll, sqliteSaveChanges, sqliteClose };
+#endif
+
+#ifndef FUZZING
+int main(int argc, char *argv[]) {
+    int choice;
+
+    // attendance --sqlite [other options]: keep data in DB_FILENAME instead
+    if (argc >= 2 && strcmp(argv[1], "--sqlite") == 0) {
+#ifdef USE_SQLITE
+        storage = &sqliteStorage;
+        dataFile = DB_FILENAME;
+        argc--;
+        argv++;
+#else
+        printf("Error: Built without SQLite (compile with -DUSE_SQLITE and link -lsqlite3).\n");
+        return 1;
+#endif
+    }
+
+    // Mark throughput and report latency of each backend: --bench-storage [marks]
+    if (argc >= 2 && strcmp(argv[1], "--bench-storage") == 0) {
+        benchmarkStorage(argc >= 3 ? atoi(argv[2]) : 2000);
+        return 0;
+    }
+
+    // Compare load time of the memory pool with plain malloc
+    if (argc >= 2 && strcmp(argv[1], "--bench-load") == 0) {
+        benchmarkLoad(argc >= 3 ? atoi(argv[2]) : 5);
+        return 0;
+    }
+
+    // Save/load round trip on generated data: attendance --stress [rows]
+    if (argc >= 2 && strcmp(argv[1], "--stress") == 0) {
+        stressTest(argc >= 3 ? atol(argv[2]) : 1000000);
+        return 0;
+    }
+
+    // Load data automatically when program starts
+    loadCalendar();
+    loadData();
+
+    // Batch mode: attendance --import roster.csv
+    if (argc == 3 && strcmp(argv[1], "--import") == 0) {
+        int rejected = 0;
+        int added = importRoster(argv[2], &rejected);
+        if (added < 0) {
+            return 1;
+        }
+        printf("Imported %d student(s), rejected %d.\n", added, rejected);
+        closeStorage();
+        return 0;
+    }
+
+    do {
+        clearScreen();
+
+        printf("\n==========Attendance  MANAGEMENT SYSTEM ==========\n");
+        if (invalidDateRows > 0) {
+            printf("Warning: %d record(s) in '%s' have an invalid date.\n", invalidDateRows, dataFile);
+        }
+        if (unreadableRows > 0) {
+            printf("Warning: %d row(s) in '%s' could not be read and were skipped.\n", unreadableRows, dataFile);
+        }
+        printf("1. Add New Student\n");
+        printf("2. View All Students\n");
+        printf("3. Mark Attendance\n");
+        printf("4. View Student Attendance\n");
+        printf("5. Search Students\n");
+        printf("6. Import Student Roster\n");
+        printf("7. Attendance Report\n");
+        printf("8. Exit\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        getchar();  // clear newline
+
+        switch(choice) {
+            case 1: addStudent(); break;
+            case 2: viewAllStudents(); break;
+            case 3: markAttendance(); break;
+            case 4: viewStudentAttendance(); break;
+            case 5: searchStudents(); break;
+            case 6: importStudents(); break;
+            case 7: attendanceReport(); break;
+            case 8: 
+                // Regroup rows per student if appends have scattered them, or
+                // if startup had to read the whole file for lack of an index
+                if (fragments > studentCount || indexMissing) {
+                    saveAllData();
+                } else {
+                    saveData();
+                }
+                closeStorage();
+                printf("\nData saved to '%s'. Exiting program. Goodbye!\n", dataFile);
+                break;
+            default:
+                printf("\nInvalid choice! Try again.\n");
+                pauseProgram();
+        }
+
+    } while(choice != 8);
+
+    return 0;
+}
+#endif
+
+// Clears the screen (Windows only)
+void clearScreen() {
+    system("cls");
+}
+
+// Simple pause
+void pauseProgram() {
+    printf("\nPress Enter to continue...");
+    getchar();
+}
+
+// Helper: Find student index by ID (binary search over the ID directory)
+int findStudentIndex(char *id) {
+    int pos = directoryBound(idIndex, id, 0, 0, 0);
+    if (pos < studentCount && strcmp(students[idIndex[pos]].id, id) == 0) {
+        return idIndex[pos];
+    }
+    return -1;
+}
+
+// === STUDENT DIRECTORY ===
+
+// Case-insensitive compare of at most len characters (len 0 = whole string)
+int compareNoCase(const char *a, const char *b, int len) {
+    for (int i = 0; len == 0 || i < len; i++) {
+        int ca = (a[i] >= 'A' && a[i] <= 'Z') ? a[i] + 32 : a[i];
+        int cb = (b[i] >= 'A' && b[i] <= 'Z') ? b[i] + 32 : b[i];
+        if (ca != cb) return ca - cb;
+        if (ca == 0) return 0;
+    }
+    return 0;
+}
+
+// Compares a student's ID or name with a key; len > 0 compares only a prefix
+int compareDirectoryKey(int studentIdx, const char *key, int len, int byName) {
+    if (byName) {
+        return compareNoCase(students[studentIdx].name, key, len);
+    }
+    if (len > 0) {
+        return strncmp(students[studentIdx].id, key, len);
+    }
+    return strcmp(students[studentIdx].id, key);
+}
+
+// Binary search: first position whose key is >= key (or > key when upper is set)
+int directoryBound(int *index, const char *key, int len, int byName, int upper) {
+    int lo = 0, hi = studentCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = compareDirectoryKey(index[mid], key, len, byName);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Adds students[studentIdx] to both directories (call before studentCount++)
+void directoryInsert(int studentIdx) {
+    int pos = directoryBound(idIndex, students[studentIdx].id, 0, 0, 0);
+    memmove(&idIndex[pos + 1], &idIndex[pos], (studentCount - pos) * sizeof(int));
+    idIndex[pos] = studentIdx;
+
+    // Equal names keep insertion order, so place after the last match
+    pos = directoryBound(nameIndex, students[studentIdx].name, 0, 1, 1);
+    memmove(&nameIndex[pos + 1], &nameIndex[pos], (studentCount - pos) * sizeof(int));
+    nameIndex[pos] = studentIdx;
+}
+
+// All entries starting with prefix; returns the match count, *first = start position
+int findPrefixRange(const char *prefix, int byName, int *first) {
+    int *index = byName ? nameIndex : idIndex;
+    int len = strlen(prefix);
+
+    if (len == 0) {
+        *first = 0;
+        return studentCount;
+    }
+    *first = directoryBound(index, prefix, len, byName, 0);
+    return directoryBound(index, prefix, len, byName, 1) - *first;
+}
+
+// All IDs between fromId and toId inclusive (toId may be a prefix, e.g. "BSE-25F")
+int findIdRange(const char *fromId, const char *toId, int *first) {
+    *first = directoryBound(idIndex, fromId, 0, 0, 0);
+    int last = directoryBound(idIndex, toId, strlen(toId), 0, 1);
+    return last > *first ? last - *first : 0;
+}
+
+// Prints count students from an index, PAGE_SIZE at a time
+void printStudentPages(int *index, int first, int count) {
+    for (int i = 0; i < count; i++) {
+        Student *s = &students[index[first + i]];
+        printf("%d. %s (ID: %s)\n", i + 1, s->name, s->id);
+
+        if ((i + 1) % PAGE_SIZE == 0 && i + 1 < count) {
+            printf("\n-- %d of %d shown. Press Enter for more, or q to stop: ", i + 1, count);
+            char answer[8];
+            fgets(answer, sizeof(answer), stdin);
+            if (answer[0] == 'q' || answer[0] == 'Q') {
+                return;
+            }
+            printf("\n");
+        }
+    }
+}
+
+// Checks the university ID format, e.g. BSE-25F-086
+int isValidStudentId(const char *id) {
+    int i = 0, letters = 0;
+
+    while (id[i] >= 'A' && id[i] <= 'Z') {
+        i++;
+        letters++;
+    }
+    if (letters < 2 || letters > 4 || id[i++] != '-') return 0;
+
+    // Two-digit year followed by the intake letter
+    if (id[i] < '0' || id[i] > '9' || id[i + 1] < '0' || id[i + 1] > '9') return 0;
+    i += 2;
+    if (id[i] < 'A' || id[i] > 'Z' || id[i + 1] != '-') return 0;
+    i += 2;
+
+    // Three-digit roll number
+    for (int k = 0; k < 3; k++, i++) {
+        if (id[i] < '0' || id[i] > '9') return 0;
+    }
+    return id[i] == 0;
+}
+
+// === END STUDENT DIRECTORY ===
+
+// === FILE OPERATIONS ===
+
+// Save pending changes through the selected backend
+void saveData() {
+    storage->saveChanges();
+}
+
+// Save everything through the selected backend
+void saveAllData() {
+    // Rows the loader skipped exist only in the file; a rewrite would drop them
+    if (unreadableRows > 0) {
+        printf("Error: %d unreadable row(s) would be lost, '%s' was not rewritten!\n",
+               unreadableRows, dataFile);
+        return;
+    }
+    // Older records still on disk must be read before the file is replaced,
+    // or the rewrite would drop them
+    if (!ensureAllHistory()) {
+        printf("Error: Older records could not be read, '%s' was not changed!\n", historySource);
+        return;
+    }
+    storage->saveAll();
+}
+
+// Load students and records through the selected backend
+void loadData() {
+    storage->load();
+}
+
+void closeStorage() {
+    if (storage->close != NULL) {
+        storage->close();
+    }
+}
+
+// Everything in memory is now in storage
+void markAllSaved() {
+    for (int i = 0; i < studentCount; i++) {
+        for (int j = 0; j < students[i].attendanceCount; j++) {
+            students[i].attendance[j].saved = 1;
+        }
+        students[i].inFile = 1;
+        students[i].dirty = 0;
+    }
+    dirtyCount = 0;
+    fragments = 0;
+}
+
+// Rows loaded from storage are already saved; alerts that already hold
+// are armed quietly so only new drops are reported
+void finishLoad() {
+    for (int i = 0; i < studentCount; i++) {
+        students[i].inFile = 1;
+        armAlerts(&students[i]);
+    }
+}
+
+// CSV: appends only the dirty students' new rows, or rewrites everything
+// if the file is missing or was never loaded.
+void csvSaveChanges() {
+    if (!fileSynced) {
+        saveAllData();
+        return;
+    }
+    if (dirtyCount > 0 && !appendDirtyStudents()) {
+        saveAllData();
+    }
+}
+
+// Flags a student for the next save
+void markDirty(int studentIdx) {
+    if (!students[studentIdx].dirty) {
+        students[studentIdx].dirty = 1;
+        dirtyList[dirtyCount++] = studentIdx;
+    }
+}
+
+// Appends one row group per dirty student. Returns 0 if the file could not be opened.
+int appendDirtyStudents() {
+    // An index that matches the file before the append is kept matching after it
+    char path[300];
+    IndexHeader header;
+    indexPath(path);
+    FILE *index = fopen(path, "r+b");
+    if (index != NULL && !readIndexHeader(index, &header)) {
+        fclose(index);
+        index = NULL;
+    }
+
+    FILE *fp = fopen(dataFile, "a");
+    if (fp == NULL) {
+        if (index != NULL) {
+            fclose(index);
+        }
+        return 0;
+    }
+
+    for (int d = 0; d < dirtyCount; d++) {
+        Student *s = &students[dirtyList[d]];
+
+        if (s->attendanceCount == 0 && !s->inFile) {
+            fprintf(fp, "%s,%s,None,None\n", s->id, s->name);
+        } else {
+            // A student already in the file now has rows in two places
+            if (s->inFile) {
+                fragments++;
+            }
+            for (int j = 0; j < s->attendanceCount; j++) {
+                if (!s->attendance[j].saved) {
+                    fprintf(fp, "%s,%s,%s,%s\n", s->id, s->name,
+                            s->attendance[j].date, s->attendance[j].status);
+                    s->attendance[j].saved = 1;
+                }
+            }
+        }
+        s->inFile = 1;
+        s->dirty = 0;
+    }
+
+    dirtyCount = 0;
+    fclose(fp);
+
+    if (index != NULL) {
+        header.fragments = fragments;
+        int ok = stampIndex(&header) && fseek(index, 0, SEEK_SET) == 0 &&
+                 fwrite(&header, sizeof(header), 1, index) == 1;
+        ok = fclose(index) == 0 && ok;
+        if (!ok) {
+            remove(path);
+        }
+    }
+    return 1;
+}
+
+// Save data to CSV (Excel compatible), one row group per student: first all
+// records before the history cutoff, then the current ones. Writes the index
+// that lets the next start skip the history section.
+void csvSaveAll() {
+    FILE *fp = fopen(dataFile, "w");
+    if (fp == NULL) {
+        printf("Error: Could not save data!\n");
+        return;
+    }
+
+    int cutoff = defaultHistoryCutoff();
+    IndexEntry *entries = (IndexEntry *)calloc(studentCount > 0 ? studentCount : 1, sizeof(IndexEntry));
+    int invalidRows = 0;
+
+    // Write CSV Header
+    fprintf(fp, "ID,Name,Date,Status\n");
+
+    // History section, in ID order
+    for (int k = 0; k < studentCount; k++) {
+        Student *s = &students[idIndex[k]];
+        int older = findRecordBound(s->attendance, s->attendanceCount, cutoff, 0);
+
+        if (entries != NULL) {
+            IndexEntry *e = &entries[k];
+            strcpy(e->id, s->id);
+            strcpy(e->name, s->name);
+            e->historyOffset = ftell(fp);
+            e->historyCount = older;
+            for (int j = 0; j < older; j++) {
+                invalidRows += s->attendance[j].day == DAY_INVALID;
+                if (strcmp(s->attendance[j].status, "Present") == 0) {
+                    e->historyPresent++;
+                    e->historyStreak = 0;
+                } else {
+                    e->historyStreak++;
+                }
+            }
+        }
+        for (int j = 0; j < older; j++) {
+            fprintf(fp, "%s,%s,%s,%s\n", s->id, s->name, s->attendance[j].date, s->attendance[j].status);
+        }
+    }
+
+    // Current section, in ID order
+    long currentOffset = ftell(fp);
+    for (int k = 0; k < studentCount; k++) {
+        Student *s = &students[idIndex[k]];
+        int older = findRecordBound(s->attendance, s->attendanceCount, cutoff, 0);
+
+        // If student has no attendance, save just their info
+        if (s->attendanceCount == 0) {
+            fprintf(fp, "%s,%s,None,None\n", s->id, s->name);
+        }
+        for (int j = older; j < s->attendanceCount; j++) {
+            fprintf(fp, "%s,%s,%s,%s\n", s->id, s->name, s->attendance[j].date, s->attendance[j].status);
+        }
+    }
+
+    long dataSize = ftell(fp);
+    fclose(fp);
+
+    // Without a fresh index the next start falls back to reading everything
+    if (entries == NULL || !writeIndex(entries, dataSize, currentOffset, cutoff, invalidRows)) {
+        char path[300];
+        indexPath(path);
+        remove(path);
+    }
+    free(entries);
+
+    markAllSaved();
+    fileSynced = 1;
+    indexMissing = 0;
+}
+
+// Load data from CSV
+void csvLoad() {
+    FILE *fp = fopen(dataFile, "r");
+    if (fp == NULL) {
+        // File doesn't exist yet (first run), just return
+        return;
+    }
+
+    char line[MAX_LINE];
+    int lastIndex = -1;
+    int endsWithNewline = 1;
+    int result, hasHeader;
+
+    // With a valid index, students come from it and only rows after the
+    // history section are read; otherwise the whole file is read
+    long currentOffset = loadIndex();
+    if (currentOffset > 0) {
+        fseek(fp, currentOffset, SEEK_SET);
+        hasHeader = 1;
+    } else {
+        // Skip the header line
+        hasHeader = readLine(fp, line, sizeof(line), &endsWithNewline) != 0;
+        indexMissing = hasHeader;
+    }
+
+    while ((result = readLine(fp, line, sizeof(line), &endsWithNewline)) != 0) {
+        // A stray carriage return would be lost as a line ending on the next load
+        if (result == -1 || strchr(line, '\r') != NULL) {
+            unreadableRows++;
+            continue;
+        }
+
+        // Blank lines carry nothing and are not written back
+        int length = strlen(line);
+        if (length == 0) {
+            continue;
+        }
+
+        char *id = strtok(line, ",");
+        char *name = strtok(NULL, ",");
+        char *date = strtok(NULL, ",");
+        char *status = strtok(NULL, ",");
+        char *extra = strtok(NULL, ",");
+
+        // Only exactly four non-empty fields are saved back unchanged, and
+        // fields that would not fit the structs cannot be saved back at all
+        if (!id || !name || !date || !status || extra ||
+            (int)(strlen(id) + strlen(name) + strlen(date) + strlen(status)) + 3 != length ||
+            strlen(id) >= MAX_ID || strlen(name) >= MAX_NAME ||
+            strlen(date) >= sizeof(((AttendanceRecord *)0)->date) ||
+            strlen(status) >= sizeof(((AttendanceRecord *)0)->status)) {
+            unreadableRows++;
+            continue;
+        }
+
+        // Check if student already exists in our RAM array
+        int index = findStudentIndex(id);
+
+        if (index == -1) {
+            // New student found in file, add to array
+            index = createStudent(id, name);
+            if (index == -1) {
+                unreadableRows++;
+                continue;
+            }
+        } else if (index != lastIndex && currentOffset == 0) {
+            // Rows of this student were split by an earlier append. With
+            // the index, a student's current rows always follow their older
+            // ones, and appends counted their own groups in the header.
+            fragments++;
+        }
+        lastIndex = index;
+
+        // If the record is not "None", add the attendance
+        if (strcmp(date, "None") != 0) {
+            // Bad dates are kept (and flagged) so saving never drops data
+            if (parseDate(date) == DAY_INVALID) {
+                invalidDateRows++;
+            }
+            int pos = addRecord(&students[index], date, status);
+            if (pos == -1) {
+                unreadableRows++;
+                continue;
+            }
+            students[index].attendance[pos].saved = 1;
+        }
+        loadedRows++;
+    }
+
+    fclose(fp);
+    finishLoad();
+
+    // Appending after an unterminated last line would merge two rows, and
+    // appending to an empty file would leave it without a header
+    fileSynced = hasHeader && endsWithNewline;
+}
+
+// Records before this day go to the history section on a full save: the
+// term start from the calendar, or else 1 January / 1 July of this year
+int defaultHistoryCutoff() {
+    if (calendar.termStart != DAY_INVALID) {
+        return calendar.termStart;
+    }
+
+    time_t now = time(NULL);
+    struct tm *today = localtime(&now);
+    char date[24];
+    sprintf(date, "%04d-%02d-01", today->tm_year + 1900, today->tm_mon < 6 ? 1 : 7);
+    return parseDate(date);
+}
+
+// Index file that belongs to dataFile
+void indexPath(char *path) {
+    sprintf(path, "%.290s.idx", dataFile);
+}
+
+// FNV-1a hash of the last bytes before size, to notice a file edited elsewhere
+unsigned hashFileTail(const char *path, long size) {
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    unsigned char buf[256];
+    long start = size > (long)sizeof(buf) ? size - (long)sizeof(buf) : 0;
+    fseek(fp, start, SEEK_SET);
+    size_t n = fread(buf, 1, size - start, fp);
+    fclose(fp);
+
+    unsigned hash = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        hash = (hash ^ buf[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Records the data file's current size, modification time and tail hash
+// in header. Returns 0 if the file cannot be examined.
+int stampIndex(IndexHeader *header) {
+    struct stat info;
+    if (stat(dataFile, &info) != 0) {
+        return 0;
+    }
+    header->dataSize = (long)info.st_size;
+    header->modified = (long long)info.st_mtime;
+    header->tailHash = hashFileTail(dataFile, header->dataSize);
+    return 1;
+}
+
+// Reads an index header. Returns 1 only if it still describes the data file
+// as it is on disk now; any edit made elsewhere makes it stale.
+int readIndexHeader(FILE *fp, IndexHeader *header) {
+    IndexHeader now;
+    if (fread(header, sizeof(*header), 1, fp) != 1 ||
+        memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) != 0 || !stampIndex(&now)) {
+        return 0;
+    }
+    return now.dataSize == header->dataSize && now.modified == header->modified &&
+           now.tailHash == header->tailHash;
+}
+
+// Writes the index for the data file just saved. Returns 0 on failure.
+int writeIndex(IndexEntry *entries, long dataSize, long currentOffset, int cutoffDay, int invalidRows) {
+    char path[300];
+    indexPath(path);
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    IndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.currentOffset = currentOffset;
+    header.cutoffDay = cutoffDay;
+    header.studentCount = studentCount;
+    header.invalidDateRows = invalidRows;
+
+    int ok = stampIndex(&header) && header.dataSize == dataSize && fwrite(&header, sizeof(header), 1, fp) == 1 &&
+             (studentCount == 0 || fwrite(entries, sizeof(IndexEntry), studentCount, fp) == (size_t)studentCount);
+    ok = fclose(fp) == 0 && ok;
+    return ok;
+}
+
+// Creates the students listed in dataFile's index, with their older records
+// left on disk. Returns where the current rows start, or 0 if the index is
+// missing or does not match the data file (nothing is loaded then).
+long loadIndex() {
+    char path[300];
+    indexPath(path);
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    IndexHeader header;
+    IndexEntry *entries = NULL;
+    int ok = readIndexHeader(fp, &header) &&
+             header.studentCount >= 0 && header.studentCount <= MAX_STUDENTS &&
+             header.currentOffset > 0 && header.currentOffset <= header.dataSize &&
+             header.invalidDateRows >= 0 && header.fragments >= 0;
+
+    if (ok) {
+        entries = (IndexEntry *)malloc((header.studentCount > 0 ? header.studentCount : 1) * sizeof(IndexEntry));
+        ok = entries != NULL &&
+             fread(entries, sizeof(IndexEntry), header.studentCount, fp) == (size_t)header.studentCount;
+    }
+    fclose(fp);
+
+    for (int i = 0; ok && i < header.studentCount; i++) {
+        IndexEntry *e = &entries[i];
+        // Every history row takes at least 8 bytes ("a,b,c,d\n")
+        ok = memchr(e->id, 0, MAX_ID) != NULL && memchr(e->name, 0, MAX_NAME) != NULL &&
+             e->historyOffset > 0 && e->historyOffset <= header.currentOffset &&
+             e->historyCount >= 0 && e->historyCount <= (header.currentOffset - e->historyOffset) / 8 &&
+             e->historyPresent >= 0 && e->historyPresent <= e->historyCount &&
+             e->historyStreak >= 0 && e->historyStreak <= e->historyCount - e->historyPresent;
+    }
+    if (!ok) {
+        free(entries);
+        return 0;
+    }
+
+    for (int i = 0; i < header.studentCount; i++) {
+        IndexEntry *e = &entries[i];
+        int index = createStudent(e->id, e->name);
+        if (index == -1) {
+            break;
+        }
+        Student *s = &students[index];
+        s->historyOffset = e->historyOffset;
+        s->unloadedCount = e->historyCount;
+        s->unloadedPresent = e->historyPresent;
+        s->unloadedStreak = e->historyStreak;
+        if (s->unloadedCount > 0) {
+            unloadedStudents++;
+        }
+    }
+    free(entries);
+
+    strncpy(historySource, dataFile, sizeof(historySource) - 1);
+    historyEnd = header.currentOffset;
+    historyCutoff = header.cutoffDay;
+    invalidDateRows += header.invalidDateRows;
+    fragments = header.fragments;
+    return header.currentOffset;
+}
+
+// Reads a student's older records from the history section and merges them
+// in front of the loaded ones. Returns 0 if the rows are not where expected.
+int loadHistory(Student *s, FILE *fp) {
+    int count = s->unloadedCount;
+    AttendanceRecord *older = (AttendanceRecord *)malloc(count * sizeof(AttendanceRecord));
+    if (older == NULL) {
+        printf("Error: Out of memory!\n");
+        return 0;
+    }
+
+    char line[MAX_LINE];
+    int terminated, present = 0, ok = fseek(fp, s->historyOffset, SEEK_SET) == 0;
+    for (int i = 0; i < count && ok; i++) {
+        ok = readLine(fp, line, sizeof(line), &terminated) == 1;
+        char *id = ok ? strtok(line, ",") : NULL;
+        char *name = id ? strtok(NULL, ",") : NULL;
+        char *date = name ? strtok(NULL, ",") : NULL;
+        char *status = date ? strtok(NULL, ",") : NULL;
+
+        ok = status != NULL && strcmp(id, s->id) == 0 &&
+             strlen(date) < sizeof(older[i].date) && strlen(status) < sizeof(older[i].status);
+        if (ok) {
+            strcpy(older[i].date, date);
+            strcpy(older[i].status, status);
+            older[i].day = parseDate(date);
+            older[i].saved = 1;
+            present += strcmp(status, "Present") == 0;
+        }
+    }
+
+    RecordBlock *block = ok ? newRecordBlock(count + s->attendanceCount + INITIAL_RECORDS) : NULL;
+    if (block == NULL) {
+        printf("Error: Could not read older records of %s from '%s'!\n", s->id, historySource);
+        free(older);
+        return 0;
+    }
+
+    // Both runs are in date order; on equal days the older rows come first
+    int a = 0, b = 0, n = 0;
+    while (a < count || b < s->attendanceCount) {
+        if (b == s->attendanceCount || (a < count && older[a].day <= s->attendance[b].day)) {
+            block->records[n++] = older[a++];
+        } else {
+            block->records[n++] = s->attendance[b++];
+        }
+    }
+    free(older);
+
+    releaseRecordBlock(s->block);
+    s->block = block;
+    s->attendance = block->records;
+    s->attendanceCount += count;
+    s->presentCount += present;
+    s->unloadedCount = 0;
+    s->unloadedPresent = 0;
+    s->unloadedStreak = 0;
+    s->historyOffset = 0;
+    unloadedStudents--;
+    dataVersion++;
+    return 1;
+}
+
+// Fallback when the index offsets are wrong: reads the whole history section
+// and takes every row of a student whose older records are not loaded yet.
+// Rows of IDs unknown so far become new students. Returns 0 if unreadable.
+int rescanHistory() {
+    FILE *fp = fopen(historySource, "r");
+    if (fp == NULL) {
+        printf("Error: Could not open '%s'!\n", historySource);
+        return 0;
+    }
+    printf("Reading all older records of '%s' again.\n", historySource);
+
+    // The cached totals are replaced by the rows actually found
+    for (int i = 0; i < studentCount; i++) {
+        if (students[i].historyOffset != 0) {
+            students[i].unloadedCount = 0;
+            students[i].unloadedPresent = 0;
+            students[i].unloadedStreak = 0;
+        }
+    }
+
+    char line[MAX_LINE];
+    int terminated, result, known = studentCount;
+    readLine(fp, line, sizeof(line), &terminated);  // header
+    while (ftell(fp) < historyEnd && (result = readLine(fp, line, sizeof(line), &terminated)) != 0) {
+        char *id = result == 1 ? strtok(line, ",") : NULL;
+        char *name = id ? strtok(NULL, ",") : NULL;
+        char *date = name ? strtok(NULL, ",") : NULL;
+        char *status = date ? strtok(NULL, ",") : NULL;
+
+        if (status == NULL || strlen(id) >= MAX_ID || strlen(name) >= MAX_NAME ||
+            strlen(date) >= sizeof(((AttendanceRecord *)0)->date) ||
+            strlen(status) >= sizeof(((AttendanceRecord *)0)->status)) {
+            unreadableRows++;
+            continue;
+        }
+
+        int index = findStudentIndex(id);
+        if (index == -1) {
+            index = createStudent(id, name);
+            if (index == -1) {
+                continue;
+            }
+            students[index].inFile = 1;
+        } else if (students[index].historyOffset == 0) {
+            // Older records of this student are in memory already
+            continue;
+        }
+
+        int pos = addRecord(&students[index], date, status);
+        if (pos != -1) {
+            students[index].attendance[pos].saved = 1;
+        }
+    }
+    fclose(fp);
+
+    for (int i = 0; i < studentCount; i++) {
+        if (students[i].historyOffset != 0 || i >= known) {
+            students[i].historyOffset = 0;
+            armAlerts(&students[i]);
+        }
+    }
+    unloadedStudents = 0;
+    return 1;
+}
+
+// Loads one student's older records if still on disk. Returns how many were added.
+int ensureHistory(Student *s) {
+    if (s->unloadedCount == 0) {
+        return 0;
+    }
+
+    int before = s->attendanceCount;
+    FILE *fp = fopen(historySource, "r");
+    if (fp == NULL) {
+        printf("Error: Could not open '%s'!\n", historySource);
+        return 0;
+    }
+    int ok = loadHistory(s, fp);
+    fclose(fp);
+    if (!ok) {
+        rescanHistory();
+    }
+    return s->attendanceCount - before;
+}
+
+// Loads the older records of every student, reading the history section once.
+// Returns 0 if some are still on disk afterwards.
+int ensureAllHistory() {
+    if (unloadedStudents == 0) {
+        return 1;
+    }
+
+    FILE *fp = fopen(historySource, "r");
+    if (fp == NULL) {
+        printf("Error: Could not open '%s'!\n", historySource);
+        return 0;
+    }
+    int ok = 1;
+    for (int k = 0; k < studentCount; k++) {
+        Student *s = &students[idIndex[k]];
+        if (s->unloadedCount > 0 && !loadHistory(s, fp)) {
+            ok = 0;
+        }
+    }
+    fclose(fp);
+
+    if (!ok) {
+        rescanHistory();
+    }
+    return unloadedStudents == 0;
+}
+
+// All of a student's records, including those not loaded yet
+int totalRecords(Student *s) {
+    return s->attendanceCount + s->unloadedCount;
+}
+
+int totalPresent(Student *s) {
+    return s->presentCount + s->unloadedPresent;
+}
+
+// Reads one line without its "\r\n". Returns 1 for a line, 0 at end of file,
+// or -1 if the line did not fit (the rest of it is skipped).
+// *terminated is 0 when the line ended at end of file instead of a newline.
+int readLine(FILE *fp, char *line, int size, int *terminated) {
+    int c, len = 0, tooLong = 0;
+
+    while ((c = getc(fp)) != EOF && c != '\n') {
+        if (len < size - 1) {
+            line[len++] = (char)c;
+        } else {
+            tooLong = 1;
+        }
+    }
+    if (c == EOF && len == 0 && !tooLong) {
+        return 0;
+    }
+
+    *terminated = c == '\n';
+    if (len > 0 && line[len - 1] == '\r') {
+        len--;
+    }
+    line[len] = 0;
+    return tooLong ? -1 : 1;
+}
+
+// Adds a student to the array and directory. Returns its index, or -1 if full.
+int createStudent(const char *id, const char *name) {
+    if (studentCount >= MAX_STUDENTS) {
+        return -1;
+    }
+
+    Student *s = &students[studentCount];
+    strcpy(s->id, id);
+    strcpy(s->name, name);
+    s->block = NULL;
+    s->attendance = NULL;
+    s->attendanceCount = 0;
+    s->presentCount = 0;
+    s->absentStreak = 0;
+    s->alertsActive = 0;
+    s->inFile = 0;
+    s->historyOffset = 0;
+    s->unloadedCount = 0;
+    s->unloadedPresent = 0;
+    s->unloadedStreak = 0;
+    s->dirty = 0;
+    directoryInsert(studentCount);
+    dataVersion++;
+    return studentCount++;
+}
+
+// Adds every valid "ID,Name" row of a roster file, then saves once.
+// Rejected rows are listed in REJECTS_FILE. Returns the number added, or -1.
+int importRoster(const char *path, int *rejected) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        printf("Error: Could not open '%s'!\n", path);
+        return -1;
+    }
+
+    FILE *rejects = fopen(REJECTS_FILE, "w");
+    if (rejects != NULL) {
+        fprintf(rejects, "Line,Reason,Row\n");
+    }
+
+    char line[MAX_LINE];
+    int lineNo = 0, added = 0, terminated, result;
+    *rejected = 0;
+
+    while ((result = readLine(fp, line, sizeof(line), &terminated)) != 0) {
+        lineNo++;
+
+        // Header and blank lines are skipped, not rejected
+        if (result == 1 && (line[0] == 0 || (lineNo == 1 && strncmp(line, "ID,", 3) == 0))) {
+            continue;
+        }
+
+        char row[MAX_LINE];
+        strcpy(row, line);
+
+        char *id = strtok(line, ",");
+        char *name = strtok(NULL, ",");
+        char *extra = strtok(NULL, ",");
+        const char *reason = NULL;
+
+        // An overlong row is one rejected row; only its start is kept
+        if (result == -1) {
+            reason = "row too long";
+        } else if (id == NULL || name == NULL || extra != NULL) {
+            reason = "expected 2 columns";
+        } else if (!isValidStudentId(id)) {
+            reason = "invalid ID format";
+        } else if (strlen(name) >= MAX_NAME) {
+            reason = "name too long";
+        } else if (findStudentIndex(id) != -1) {
+            reason = "duplicate ID";
+        } else if (studentCount >= MAX_STUDENTS) {
+            reason = "student limit reached";
+        }
+
+        if (reason != NULL) {
+            (*rejected)++;
+            if (rejects != NULL) {
+                // Quotes inside the row are doubled, as CSV expects
+                fprintf(rejects, "%d,%s,\"", lineNo, reason);
+                for (char *c = row; *c; c++) {
+                    if (*c == '"') {
+                        fputc('"', rejects);
+                    }
+                    fputc(*c, rejects);
+                }
+                fprintf(rejects, "\"\n");
+            }
+            continue;
+        }
+
+        // The directory insert makes later duplicates in the same file visible
+        markDirty(createStudent(id, name));
+        added++;
+    }
+
+    fclose(fp);
+    if (rejects != NULL) {
+        fclose(rejects);
+    }
+
+    if (added > 0) {
+        saveData(); // One save for the whole roster
+    }
+    return added;
+}
+
+// === END FILE OPERATIONS ===
+
+// === DATES ===
+
+// Converts a YYYY-MM-DD date to days since 1970-01-01.
+// Returns DAY_INVALID unless it is a real calendar date from 1970 to 9999.
+int parseDate(const char *text) {
+    static const int monthDays[13] = { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    if (strlen(text) != 10) {
+        return DAY_INVALID;
+    }
+
+    // Fixed layout: every position is checked, then one test decides
+    int bad = (text[4] != '-') | (text[7] != '-');
+    int digits[8], pos[8] = { 0, 1, 2, 3, 5, 6, 8, 9 };
+    for (int i = 0; i < 8; i++) {
+        digits[i] = text[pos[i]] - '0';
+        bad |= (unsigned)digits[i] > 9;
+    }
+    if (bad) {
+        return DAY_INVALID;
+    }
+
+    int y = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+    int m = digits[4] * 10 + digits[5];
+    int d = digits[6] * 10 + digits[7];
+    if (y < 1970 || m < 1 || m > 12) {
+        return DAY_INVALID;
+    }
+    int leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    if (d < 1 || d > monthDays[m] + (m == 2 && leap)) {
+        return DAY_INVALID;
+    }
+
+    // Days from civil date, counting years from March so leap days come last
+    y -= m <= 2;
+    int era = y / 400;
+    int yearOfEra = y - era * 400;
+    int dayOfYear = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// 0 = Sunday ... 6 = Saturday (1970-01-01 was a Thursday)
+int weekday(int day) {
+    return (day + 4) % 7;
+}
+
+// 1 if classes are held on this day according to the calendar
+int isClassDay(int day) {
+    if (day == DAY_INVALID || !(calendar.classDays & (1 << weekday(day)))) {
+        return 0;
+    }
+    if (calendar.termStart != DAY_INVALID && (day < calendar.termStart || day > calendar.termEnd)) {
+        return 0;
+    }
+
+    int lo = 0, hi = calendar.holidayCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (calendar.holidays[mid] < day) lo = mid + 1; else hi = mid;
+    }
+    return lo == calendar.holidayCount || calendar.holidays[lo] != day;
+}
+
+// Position of a class day within the term (0 = first class), or -1
+int classDayIndex(int day) {
+    if (calendar.termStart == DAY_INVALID || !isClassDay(day)) {
+        return -1;
+    }
+
+    int perWeek = 0, inPartialWeek = 0;
+    int offset = day - calendar.termStart;
+    for (int w = 0; w < 7; w++) {
+        int bit = calendar.classDays & (1 << w);
+        perWeek += bit != 0;
+        // Weekdays from term start up to (not including) day in the last week
+        inPartialWeek += bit != 0 && (w - weekday(calendar.termStart) + 7) % 7 < offset % 7;
+    }
+
+    // Holidays are sorted and only hold class days, so count those before day
+    int holidaysBefore = 0;
+    while (holidaysBefore < calendar.holidayCount && calendar.holidays[holidaysBefore] < day) {
+        holidaysBefore++;
+    }
+    return offset / 7 * perWeek + inPartialWeek - holidaysBefore;
+}
+
+// Reads CALENDAR_FILE lines such as:
+//   term_start=2025-09-01   term_end=2026-01-31
+//   class_days=Mon,Tue,Wed,Thu,Fri   holiday=2025-12-25
+void loadCalendar() {
+    FILE *fp = fopen(CALENDAR_FILE, "r");
+    if (fp == NULL) {
+        return;
+    }
+
+    static const char *dayNames[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    char line[256];
+    int holidays[MAX_HOLIDAYS], holidayCount = 0;
+
+    while (fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\r\n")] = 0;
+        char *value = strchr(line, '=');
+        if (line[0] == '#' || value == NULL) {
+            continue;
+        }
+        *value++ = 0;
+
+        if (strcmp(line, "term_start") == 0) {
+            calendar.termStart = parseDate(value);
+        } else if (strcmp(line, "term_end") == 0) {
+            calendar.termEnd = parseDate(value);
+        } else if (strcmp(line, "class_days") == 0) {
+            calendar.classDays = 0;
+            for (int w = 0; w < 7; w++) {
+                if (strstr(value, dayNames[w]) != NULL) {
+                    calendar.classDays |= 1 << w;
+                }
+            }
+        } else if (strcmp(line, "holiday") == 0 && holidayCount < MAX_HOLIDAYS) {
+            int day = parseDate(value);
+            if (day != DAY_INVALID) {
+                holidays[holidayCount++] = day;
+            }
+        }
+    }
+    fclose(fp);
+
+    // A term needs both ends; an open end runs to the last valid date
+    if (calendar.termStart != DAY_INVALID && calendar.termEnd == DAY_INVALID) {
+        calendar.termEnd = DAY_MAX;
+    }
+
+    // Keep holidays that fall on class days, sorted, without duplicates
+    calendar.holidayCount = 0;
+    for (int i = 0; i < holidayCount; i++) {
+        int day = holidays[i];
+        if (!isClassDay(day)) {
+            continue;  // also skips a repeat, which is already a holiday
+        }
+        int j = calendar.holidayCount;
+        while (j > 0 && calendar.holidays[j - 1] > day) {
+            calendar.holidays[j] = calendar.holidays[j - 1];
+            j--;
+        }
+        calendar.holidays[j] = day;
+        calendar.holidayCount++;
+    }
+}
+
+// Prompts for a date range; blank ends are open. Returns 0 on a bad date.
+int readDateRange(int *fromDay, int *toDay) {
+    char from[15], to[15];
+    printf("From date (YYYY-MM-DD, blank for all): ");
+    fgets(from, sizeof(from), stdin);
+    from[strcspn(from, "\n")] = 0;
+    printf("To date (YYYY-MM-DD, blank for all): ");
+    fgets(to, sizeof(to), stdin);
+    to[strcspn(to, "\n")] = 0;
+
+    *fromDay = from[0] ? parseDate(from) : DAY_INVALID;
+    *toDay = to[0] ? parseDate(to) : DAY_MAX;
+    if ((from[0] && *fromDay == DAY_INVALID) || *toDay == DAY_INVALID) {
+        printf("Invalid date! Use a real date as YYYY-MM-DD.\n");
+        return 0;
+    }
+    return 1;
+}
+
+// === END DATES ===
+
+// === ALERTS ===
+
+// 1 if the student currently breaks the rule (uses cached totals only)
+int ruleTriggered(Student *s, AlertRule *rule) {
+    if (rule->type == RULE_BELOW_PERCENT) {
+        return totalRecords(s) >= rule->minClasses && totalRecords(s) > 0 &&
+               totalPresent(s) * 100 < rule->threshold * totalRecords(s);
+    }
+    if (rule->type == RULE_ABSENT_STREAK) {
+        return s->absentStreak >= rule->threshold;
+    }
+    return 0;
+}
+
+// Runs every rule after a mark and writes newly triggered alerts to ALERTS_FILE.
+// A rule fires once, then re-arms after the student recovers.
+void evaluateAlerts(int studentIdx, const char *date) {
+    Student *s = &students[studentIdx];
+    FILE *fp = NULL;
+
+    for (int r = 0; r < alertRuleCount; r++) {
+        int bit = 1 << r;
+        if (!ruleTriggered(s, &alertRules[r])) {
+            s->alertsActive &= ~bit;
+            continue;
+        }
+        if (s->alertsActive & bit) {
+            continue;
+        }
+        s->alertsActive |= bit;
+
+        // The message comes from the rule itself, so it follows its threshold
+        char message[64];
+        if (alertRules[r].type == RULE_BELOW_PERCENT) {
+            sprintf(message, "attendance below %d%%", alertRules[r].threshold);
+        } else {
+            sprintf(message, "%d consecutive absences", alertRules[r].threshold);
+        }
+
+        if (fp == NULL) {
+            // Header only when the outbox is new
+            fp = fopen(ALERTS_FILE, "r");
+            int exists = fp != NULL;
+            if (exists) {
+                fclose(fp);
+            }
+            fp = fopen(ALERTS_FILE, "a");
+            if (fp == NULL) {
+                printf("Error: Could not write '%s'!\n", ALERTS_FILE);
+                return;
+            }
+            if (!exists) {
+                fprintf(fp, "Date,ID,Name,Alert,Present,Total\n");
+            }
+        }
+        fprintf(fp, "%s,%s,%s,%s,%d,%d\n", date, s->id, s->name,
+                message, totalPresent(s), totalRecords(s));
+        printf("\nALERT: %s (%s) - %s\n", s->name, s->id, message);
+    }
+
+    if (fp != NULL) {
+        fclose(fp);
+    }
+}
+
+// Rebuilds the absence run after loading and marks already-broken rules as fired
+void armAlerts(Student *s) {
+    s->absentStreak = 0;
+    int j;
+    for (j = s->attendanceCount - 1; j >= 0; j--) {
+        if (strcmp(s->attendance[j].status, "Present") == 0) {
+            break;
+        }
+        s->absentStreak++;
+    }
+    // The run may continue into records still on disk
+    if (j < 0) {
+        s->absentStreak += s->unloadedStreak;
+    }
+
+    s->alertsActive = 0;
+    for (int r = 0; r < alertRuleCount; r++) {
+        if (ruleTriggered(s, &alertRules[r])) {
+            s->alertsActive |= 1 << r;
+        }
+    }
+}
+
+// === END ALERTS ===
+
+#ifdef USE_SQLITE
+// === SQLITE STORAGE ===
+
+// Opens (or creates) the database at dataFile. Returns 0 on failure.
+int sqliteOpen() {
+    if (db != NULL && strcmp(dbPath, dataFile) == 0) {
+        return 1;
+    }
+    sqliteClose();
+
+    if (sqlite3_open(dataFile, &db) != SQLITE_OK) {
+        printf("Error: Could not open '%s': %s\n", dataFile, sqlite3_errmsg(db));
+        sqlite3_close(db);
+        db = NULL;
+        return 0;
+    }
+
+    // WAL lets each mark commit as one small append to the log
+    if (!sqliteExec("PRAGMA journal_mode=WAL;"
+                    "PRAGMA synchronous=NORMAL;"
+                    "CREATE TABLE IF NOT EXISTS students("
+                    "  id TEXT PRIMARY KEY, name TEXT NOT NULL);"
+                    "CREATE TABLE IF NOT EXISTS attendance("
+                    "  student_id TEXT NOT NULL, day INTEGER NOT NULL,"
+                    "  date TEXT NOT NULL, status TEXT NOT NULL);"
+                    "CREATE INDEX IF NOT EXISTS attendance_by_student ON attendance(student_id, day);"
+                    "CREATE INDEX IF NOT EXISTS attendance_by_day ON attendance(day);") ||
+        sqlite3_prepare_v2(db, "INSERT INTO students(id, name) VALUES (?, ?)",
+                           -1, &insertStudentStmt, NULL) != SQLITE_OK ||
+        sqlite3_prepare_v2(db, "INSERT INTO attendance(student_id, day, date, status) VALUES (?, ?, ?, ?)",
+                           -1, &insertRecordStmt, NULL) != SQLITE_OK) {
+        printf("Error: Could not prepare '%s': %s\n", dataFile, sqlite3_errmsg(db));
+        sqliteClose();
+        return 0;
+    }
+
+    strncpy(dbPath, dataFile, sizeof(dbPath) - 1);
+    return 1;
+}
+
+void sqliteClose() {
+    sqlite3_finalize(insertStudentStmt);
+    sqlite3_finalize(insertRecordStmt);
+    insertStudentStmt = NULL;
+    insertRecordStmt = NULL;
+    sqlite3_close(db);
+    db = NULL;
+    dbPath[0] = 0;
+}
+
+// Runs SQL without results. Returns 0 on failure.
+int sqliteExec(const char *sql) {
+    char *error = NULL;
+    if (sqlite3_exec(db, sql, NULL, NULL, &error) != SQLITE_OK) {
+        printf("Error: Database: %s\n", error);
+        sqlite3_free(error);
+        return 0;
+    }
+    return 1;
+}
+
+void sqliteLoad() {
+    if (!sqliteOpen()) {
+        return;
+    }
+
+    sqlite3_stmt *stmt;
+    sqlite3_prepare_v2(db, "SELECT id, name FROM students ORDER BY rowid", -1, &stmt, NULL);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char *id = (const char *)sqlite3_column_text(stmt, 0);
+        const char *name = (const char *)sqlite3_column_text(stmt, 1);
+        if (id == NULL || name == NULL || strlen(id) >= MAX_ID || strlen(name) >= MAX_NAME) {
+            unreadableRows++;
+            continue;
+        }
+        createStudent(id, name);
+    }
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db, "SELECT student_id, date, status FROM attendance ORDER BY rowid",
+                       -1, &stmt, NULL);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char *id = (const char *)sqlite3_column_text(stmt, 0);
+        const char *date = (const char *)sqlite3_column_text(stmt, 1);
+        const char *status = (const char *)sqlite3_column_text(stmt, 2);
+        int index = id != NULL ? findStudentIndex((char *)id) : -1;
+
+        if (index == -1 || date == NULL || status == NULL ||
+            strlen(date) >= sizeof(((AttendanceRecord *)0)->date) ||
+            strlen(status) >= sizeof(((AttendanceRecord *)0)->status)) {
+            unreadableRows++;
+            continue;
+        }
+        if (parseDate(date) == DAY_INVALID) {
+            invalidDateRows++;
+        }
+        int pos = addRecord(&students[index], date, status);
+        if (pos != -1) {
+            students[index].attendance[pos].saved = 1;
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    finishLoad();
+    fileSynced = 1;
+}
+
+// Executes a prepared insert with the student's ID and name
+int sqliteInsertStudent(Student *s) {
+    sqlite3_reset(insertStudentStmt);
+    sqlite3_bind_text(insertStudentStmt, 1, s->id, -1, SQLITE_STATIC);
+    sqlite3_bind_text(insertStudentStmt, 2, s->name, -1, SQLITE_STATIC);
+    return sqlite3_step(insertStudentStmt) == SQLITE_DONE;
+}
+
+// Executes a prepared insert for one record of a student
+int sqliteInsertRecord(Student *s, AttendanceRecord *r) {
+    sqlite3_reset(insertRecordStmt);
+    sqlite3_bind_text(insertRecordStmt, 1, s->id, -1, SQLITE_STATIC);
+    sqlite3_bind_int(insertRecordStmt, 2, r->day);
+    sqlite3_bind_text(insertRecordStmt, 3, r->date, -1, SQLITE_STATIC);
+    sqlite3_bind_text(insertRecordStmt, 4, r->status, -1, SQLITE_STATIC);
+    return sqlite3_step(insertRecordStmt) == SQLITE_DONE;
+}
+
+// Replaces the database contents in one transaction
+void sqliteSaveAll() {
+    if (!sqliteOpen() || !sqliteExec("BEGIN; DELETE FROM attendance; DELETE FROM students;")) {
+        return;
+    }
+
+    int ok = 1;
+    for (int i = 0; i < studentCount && ok; i++) {
+        ok = sqliteInsertStudent(&students[i]);
+        for (int j = 0; j < students[i].attendanceCount && ok; j++) {
+            ok = sqliteInsertRecord(&students[i], &students[i].attendance[j]);
+        }
+    }
+
+    if (!ok) {
+        printf("Error: Could not save data: %s\n", sqlite3_errmsg(db));
+        sqliteExec("ROLLBACK;");
+        return;
+    }
+    sqliteExec("COMMIT;");
+    markAllSaved();
+    fileSynced = 1;
+}
+
+// Inserts the new students and records of dirty students in one transaction,
+// so a single mark is a single-row insert
+void sqliteSaveChanges() {
+    if (dirtyCount == 0 || !sqliteOpen() || !sqliteExec("BEGIN;")) {
+        return;
+    }
+
+    int ok = 1;
+    for (int d = 0; d < dirtyCount && ok; d++) {
+        Student *s = &students[dirtyList[d]];
+        if (!s->inFile) {
+            ok = sqliteInsertStudent(s);
+        }
+        for (int j = 0; j < s->attendanceCount && ok; j++) {
+            if (!s->attendance[j].saved) {
+                ok = sqliteInsertRecord(s, &s->attendance[j]);
+            }
+        }
+    }
+
+    if (!ok) {
+        printf("Error: Could not save data: %s\n", sqlite3_errmsg(db));
+        sqliteExec("ROLLBACK;");
+        return;
+    }
+    sqliteExec("COMMIT;");
+
+    for (int d = 0; d < dirtyCount; d++) {
+        Student *s = &students[dirtyList[d]];
+        for (int j = 0; j < s->attendanceCount; j++) {
+            s->attendance[j].saved = 1;
+        }
+        s->inFile = 1;
+        s->dirty = 0;
+    }
+    dirtyCount = 0;
+}
+
+// Same report as writeReport(), answered by the database indexes
+int sqliteReport(int fromDay, int toDay, const char *path) {
+    if (!sqliteOpen()) {
+        return -1;
+    }
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        printf("Error: Could not write '%s'!\n", path);
+        return -1;
+    }
+
+    sqlite3_stmt *stmt;
+    sqlite3_prepare_v2(db,
+        "SELECT s.id, s.name, COUNT(a.day), COALESCE(SUM(a.status = 'Present'), 0) "
+        "FROM students s LEFT JOIN attendance a "
+        "  ON a.student_id = s.id AND a.day BETWEEN ? AND ? "
+        "GROUP BY s.id ORDER BY s.id", -1, &stmt, NULL);
+    sqlite3_bind_int(stmt, 1, fromDay);
+    sqlite3_bind_int(stmt, 2, toDay);
+
+    int written = 0;
+    fprintf(fp, "ID,Name,Total,Present,Absent,Percentage\n");
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        int total = sqlite3_column_int(stmt, 2), present = sqlite3_column_int(stmt, 3);
+        fprintf(fp, "%s,%s,%d,%d,%d,%.1f\n", sqlite3_column_text(stmt, 0), sqlite3_column_text(stmt, 1),
+                total, present, total - present, total > 0 ? 100.0 * present / total : 0.0);
+        written++;
+    }
+    sqlite3_finalize(stmt);
+    fclose(fp);
+    return written;
+}
+
+// Deletes a database file with its WAL side files
+void removeDatabase(const char *path) {
+    char side[300];
+    remove(path);
+    sprintf(side, "%s-wal", path);
+    remove(side);
+    sprintf(side, "%s-shm", path);
+    remove(side);
+}
+
+// === END SQLITE STORAGE ===
+#endif
 
-// Function prototypes
-void addStudent();
-void markAttendance();
-void viewAllStudents();
-void viewStudentAttendance();
-void clearScreen();
-void pauseProgram();
-void saveData();
-void loadData();
-int findStudentIndex(char *id);
+// === ROUND-TRIP CHECKS ===
 
-int main() {
-    int choice;
+// 1 if both files have identical bytes
+int sameFiles(const char *a, const char *b) {
+    FILE *fa = fopen(a, "rb");
+    FILE *fb = fopen(b, "rb");
+    int same = fa != NULL && fb != NULL;
 
-    // Load data automatically when program starts
+    while (same) {
+        char bufA[4096], bufB[4096];
+        size_t na = fread(bufA, 1, sizeof(bufA), fa);
+        size_t nb = fread(bufB, 1, sizeof(bufB), fb);
+        same = na == nb && memcmp(bufA, bufB, na) == 0;
+        if (na == 0) {
+            break;
+        }
+    }
+
+    if (fa != NULL) fclose(fa);
+    if (fb != NULL) fclose(fb);
+    return same;
+}
+
+// Deletes a CSV data file with its index
+void removeDataFile(const char *path) {
+    char side[300];
+    remove(path);
+    sprintf(side, "%.290s.idx", path);
+    remove(side);
+}
+
+// Non-blank rows after the header line, as the loader sees them
+long countDataRows(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    char line[MAX_LINE];
+    int terminated, result;
+    long rows = 0;
+    readLine(fp, line, sizeof(line), &terminated);
+    while ((result = readLine(fp, line, sizeof(line), &terminated)) != 0) {
+        if (result == -1 || line[0] != 0) {
+            rows++;
+        }
+    }
+    fclose(fp);
+    return rows;
+}
+
+// All records in memory or still on disk
+long countRecords() {
+    long records = 0;
+    for (int i = 0; i < studentCount; i++) {
+        records += totalRecords(&students[i]);
+    }
+    return records;
+}
+
+// Loads source, saves it as first, loads first and saves it as second.
+// Every source row must be loaded or counted as unreadable; with unreadable
+// rows the save must be refused. Otherwise the first save must keep every
+// record, and the two saves must match.
+int roundTrip(const char *source, const char *first, const char *second) {
+    const char *previous = dataFile;
+    resetData();
+    dataFile = source;
     loadData();
+    int ok = loadedRows + unreadableRows == countDataRows(source);
+    long records = countRecords();
+
+    removeDataFile(first);
+    dataFile = first;
+    saveAllData();
+    if (unreadableRows > 0) {
+        FILE *fp = fopen(first, "r");
+        if (fp != NULL) {
+            fclose(fp);
+            ok = 0;
+        }
+        dataFile = previous;
+        return ok;
+    }
 
-    do {
-        clearScreen();
+    resetData();
+    loadData();
+    ok = ok && countRecords() == records;
+    dataFile = second;
+    saveAllData();
 
-        printf("\n==========Attendance  MANAGEMENT SYSTEM ==========\n");
-        printf("1. Add New Student\n");
-        printf("2. View All Students\n");
-        printf("3. Mark Attendance\n");
-        printf("4. View Student Attendance\n");
-        printf("5. Exit\n");
-        printf("Enter your choice: ");
-        scanf("%d", &choice);
-        getchar();  // clear newline
+    dataFile = previous;
+    return ok && sameFiles(first, second);
+}
 
-        switch(choice) {
-            case 1: addStudent(); break;
-            case 2: viewAllStudents(); break;
-            case 3: markAttendance(); break;
-            case 4: viewStudentAttendance(); break;
-            case 5: 
-                saveData(); // Save before exiting
-                printf("\nData saved to '%s'. Exiting program. Goodbye!\n", FILENAME);
-                break;
-            default:
-                printf("\nInvalid choice! Try again.\n");
-                pauseProgram();
+// Replaces the loaded data with generated students holding about rows
+// records in total. Returns the number of records made.
+long generateData(long rows) {
+    int studentsWanted = rows / 200 + 1;
+    if (studentsWanted > MAX_STUDENTS) studentsWanted = MAX_STUDENTS;
+    int perStudent = (int)(rows / studentsWanted + 1);
+
+    resetData();
+    srand(42);
+    long made = 0;
+    for (int i = 0; i < studentsWanted; i++) {
+        char id[MAX_ID], name[MAX_NAME];
+        sprintf(id, "BSE-%02dF-%03d", 20 + i / 1000, i % 1000);
+        sprintf(name, "Student %d Test", i);
+        int idx = createStudent(id, name);
+
+        for (int r = 0; r < perStudent && made < rows; r++, made++) {
+            char date[15];
+            // Every 1000th record carries an invalid date, like real data does
+            if (made % 1000 == 999) {
+                strcpy(date, "2025-87-67");
+            } else {
+                sprintf(date, "%04d-%02d-%02d", 2000 + r / 336 % 100, r / 28 % 12 + 1, r % 28 + 1);
+            }
+            addRecord(&students[idx], date, rand() % 5 ? "Present" : "Absent");
+        }
+    }
+    return made;
+}
+
+// Generates about rows records, then checks and times full saves, loads and
+// incremental appends. Uses its own files, never the real data file.
+void stressTest(long rows) {
+    const char *generated = "stress_generated.csv";
+    const char *reloaded = "stress_reloaded.csv";
+    const char *expected = "stress_expected.csv";
+    const char *appended = "stress_appended.csv";
+
+    // The CSV checks run on the CSV backend whichever one was selected
+    StorageBackend *previousStorage = storage;
+    const char *previousFile = dataFile;
+    storage = &csvStorage;
+
+    long made = generateData(rows);
+    printf("Generated %d students, %ld records.\n", studentCount, made);
+
+    clock_t start = clock();
+    dataFile = generated;
+    saveAllData();
+    double saveMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    resetData();
+    start = clock();
+    loadData();
+    double loadMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+    int lazyStudents = unloadedStudents;
+    int loadOk = countRecords() == made && unreadableRows == 0;
+
+    // Older records are read on demand; time reading all of them
+    start = clock();
+    ensureAllHistory();
+    double historyMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    dataFile = reloaded;
+    saveAllData();
+    int fullOk = loadOk && sameFiles(generated, reloaded);
+
+    // Append a record to every 10th student, as a day of marking would
+    for (int i = 0; i < studentCount; i += 10) {
+        addRecord(&students[i], "2099-12-31", "Absent");
+        markDirty(i);
+    }
+    start = clock();
+    saveData();
+    double appendMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    dataFile = expected;
+    saveAllData();
+    resetData();
+    dataFile = reloaded;
+    loadData();
+    dataFile = appended;
+    saveAllData();
+    int appendOk = sameFiles(expected, appended);
+
+    printf("Full save:   %8.1f ms (%.0f rows/s)\n", saveMs, made / (saveMs / 1000.0 + 1e-9));
+    printf("Load:        %8.1f ms (%d students with history left on disk)\n", loadMs, lazyStudents);
+    printf("History:     %8.1f ms (all older records read)\n", historyMs);
+    printf("Append save: %8.1f ms (%d students)\n", appendMs, (studentCount + 9) / 10);
+    printf("Save -> load -> save:   %s\n", fullOk ? "OK" : "MISMATCH");
+    printf("Append -> load -> save: %s\n", appendOk ? "OK" : "MISMATCH");
+
+#ifdef USE_SQLITE
+    // The same data through the database: CSV -> SQLite -> CSV must match
+    const char *database = "stress_data.db";
+    removeDatabase(database);
+    storage = &sqliteStorage;
+    dataFile = database;
+    start = clock();
+    saveAllData();
+    double dbSaveMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    resetData();
+    start = clock();
+    loadData();
+    double dbLoadMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    storage = &csvStorage;
+    dataFile = appended;
+    saveAllData();
+    int dbOk = sameFiles(expected, appended) && unreadableRows == 0;
+
+    printf("SQLite save: %8.1f ms (%.0f rows/s)\n", dbSaveMs, made / (dbSaveMs / 1000.0 + 1e-9));
+    printf("SQLite load: %8.1f ms (%.0f rows/s)\n", dbLoadMs, made / (dbLoadMs / 1000.0 + 1e-9));
+    printf("CSV -> SQLite -> CSV:   %s\n", dbOk ? "OK" : "MISMATCH");
+    sqliteClose();
+    removeDatabase(database);
+#endif
+
+    removeDataFile(generated);
+    removeDataFile(reloaded);
+    removeDataFile(expected);
+    removeDataFile(appended);
+    storage = previousStorage;
+    dataFile = previousFile;
+}
+
+// Marks attendance one record and one save at a time on generated data, then
+// times a date-range report, for each backend. Uses its own files.
+void benchmarkStorage(int marks) {
+    StorageBackend *backends[2] = { &csvStorage, NULL };
+    const char *files[2] = { "bench_data.csv", "bench_data.db" };
+    const char *reports[2] = { "bench_report_csv.csv", "bench_report_db.csv" };
+#ifdef USE_SQLITE
+    backends[1] = &sqliteStorage;
+#endif
+    StorageBackend *previousStorage = storage;
+    const char *previousFile = dataFile;
+    int fromDay = parseDate("2000-03-01"), toDay = parseDate("2000-06-30");
+
+    printf("%-8s %12s %14s %16s\n", "Backend", "Marks/s", "Report (ms)", "Report source");
+    for (int b = 0; b < 2 && backends[b] != NULL; b++) {
+        storage = backends[b];
+        dataFile = files[b];
+        removeDataFile(files[b]);
+#ifdef USE_SQLITE
+        removeDatabase(files[b]);
+#endif
+        generateData(200000);
+        saveAllData();
+
+        // Each mark is saved on its own, as markAttendance() does
+        clock_t start = clock();
+        for (int i = 0; i < marks; i++) {
+            int idx = (int)((i * 7L) % studentCount);
+            addRecord(&students[idx], "2000-05-15", i % 4 ? "Present" : "Absent");
+            markDirty(idx);
+            saveData();
         }
+        double markSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        if (storage == &csvStorage) {
+            Snapshot *snap = takeSnapshot();
+            writeReport(snap, fromDay, toDay, reports[b]);
+            releaseSnapshot(snap);
+        }
+#ifdef USE_SQLITE
+        else {
+            sqliteReport(fromDay, toDay, reports[b]);
+        }
+#endif
+        double reportMs = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+        printf("%-8s %12.0f %14.2f %16s\n", storage->name, marks / (markSeconds + 1e-9), reportMs,
+               storage == &csvStorage ? "memory snapshot" : "SQL indexes");
+        closeStorage();
+    }
+
+#ifdef USE_SQLITE
+    printf("Reports match: %s\n", sameFiles(reports[0], reports[1]) ? "yes" : "NO");
+    removeDatabase(files[1]);
+#endif
+    removeDataFile(files[0]);
+    remove(reports[0]);
+    remove(reports[1]);
+    storage = previousStorage;
+    dataFile = previousFile;
+}
 
-    } while(choice != 5);
+#ifdef FUZZING
+// libFuzzer entry: clang -DFUZZING -fsanitize=fuzzer,address "main V2.0.cpp"
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, size_t size) {
+    FILE *fp = fopen("fuzz_input.csv", "wb");
+    if (fp == NULL) {
+        return 0;
+    }
+    fwrite(data, 1, size, fp);
+    fclose(fp);
 
+    if (!roundTrip("fuzz_input.csv", "fuzz_first.csv", "fuzz_second.csv")) {
+        abort();
+    }
     return 0;
 }
+#endif
 
-// Clears the screen (Windows only)
-void clearScreen() {
-    system("cls");
+// === END ROUND-TRIP CHECKS ===
+
+// === MEMORY POOL ===
+
+// Hands out bytes from the current chunk, moving on to a reused or new chunk when full
+void *arenaAlloc(size_t bytes) {
+    bytes = (bytes + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+
+    while (arenaCurrent != NULL && arenaCurrent->used + bytes > arenaCurrent->size) {
+        arenaCurrent = arenaCurrent->next;
+        if (arenaCurrent != NULL) {
+            arenaCurrent->used = 0;  // chunk kept from before the last reset
+        }
+    }
+
+    if (arenaCurrent == NULL) {
+        size_t size = bytes > ARENA_CHUNK_SIZE ? bytes : ARENA_CHUNK_SIZE;
+        ArenaChunk *chunk = (ArenaChunk *)malloc(sizeof(ArenaChunk) + size);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        allocCount++;
+        chunk->size = size;
+        chunk->used = 0;
+        chunk->next = NULL;
+
+        // Chunks stay in allocation order so a reset reuses them in order
+        if (arenaTail != NULL) {
+            arenaTail->next = chunk;
+        } else {
+            arenaHead = chunk;
+        }
+        arenaTail = chunk;
+        arenaCurrent = chunk;
+    }
+
+    void *p = (char *)arenaCurrent->data + arenaCurrent->used;
+    arenaCurrent->used += bytes;
+    return p;
 }
 
-// Simple pause
-void pauseProgram() {
-    printf("\nPress Enter to continue...");
-    getchar();
+// Frees everything handed out so far in O(1); chunks are kept for reuse
+void arenaReset() {
+    arenaCurrent = arenaHead;
+    if (arenaCurrent != NULL) {
+        arenaCurrent->used = 0;
+    }
 }
 
-// Helper: Find student index by ID
-int findStudentIndex(char *id) {
-    for (int i = 0; i < studentCount; i++) {
-        if (strcmp(students[i].id, id) == 0) {
-            return i;
+// Forgets all students and records so data can be loaded again.
+// Returns 0 while a snapshot still reads the current data.
+int resetData() {
+    if (liveSnapshots > 0) {
+        printf("Error: A report is still reading the data!\n");
+        return 0;
+    }
+
+    if (useArena) {
+        arenaReset();
+    } else {
+        for (int i = 0; i < studentCount; i++) {
+            releaseRecordBlock(students[i].block);
         }
     }
-    return -1;
+
+    studentCount = 0;
+    dirtyCount = 0;
+    fragments = 0;
+    fileSynced = 0;
+    invalidDateRows = 0;
+    unreadableRows = 0;
+    loadedRows = 0;
+    indexMissing = 0;
+    unloadedStudents = 0;
+    historySource[0] = 0;
+    historyEnd = 0;
+    historyCutoff = DAY_INVALID;
+    dataVersion++;
+    return 1;
 }
 
-// === FILE OPERATIONS ===
+// Loads FILENAME repeatedly with each allocator and prints the average time
+// and the malloc calls of the first round (later pool rounds reuse its chunks)
+void benchmarkLoad(int rounds) {
+    const char *names[2] = { "malloc", "memory pool" };
+    if (rounds < 1) rounds = 1;
+
+    printf("%-12s %10s %12s %14s\n", "Allocator", "Students", "Load (ms)", "malloc calls");
+    for (int mode = 0; mode < 2; mode++) {
+        double totalMs = 0;
+        long allocs = 0;
+
+        for (int r = 0; r < rounds; r++) {
+            resetData();
+            useArena = mode;
+            allocCount = 0;
+
+            // Older records count too, or the lazy load would hide them
+            clock_t start = clock();
+            loadData();
+            ensureAllHistory();
+            totalMs += 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+            if (r == 0) {
+                allocs = allocCount;
+            }
+        }
+        printf("%-12s %10d %12.2f %14ld\n", names[mode], studentCount, totalMs / rounds, allocs);
+    }
+}
 
-// Save data to CSV (Excel compatible)
-void saveData() {
-    FILE *fp = fopen(FILENAME, "w");
-    if (fp == NULL) {
-        printf("Error: Could not save data!\n");
-        return;
+// === END MEMORY POOL ===
+
+// === ATTENDANCE RECORDS ===
+
+// Inserts an unsaved record in date order and updates the cached totals.
+// Returns its position, or -1 if memory ran out.
+int addRecord(Student *s, const char *date, const char *status) {
+    int day = parseDate(date);
+
+    // Records are usually marked in date order, so this is normally the end
+    int pos = findRecordBound(s->attendance, s->attendanceCount, day, 1);
+
+    if (s->block == NULL) {
+        detachRecords(s, INITIAL_RECORDS);
+    } else if (s->attendanceCount == s->block->capacity) {
+        detachRecords(s, s->block->capacity * 2);
+    } else if (s->block->refs > 1 && pos < s->attendanceCount) {
+        // Appends land past every snapshot's count; inserts would shift their records
+        detachRecords(s, s->block->capacity);
+    }
+    if (s->block == NULL) {
+        return -1;
+    }
+    memmove(&s->attendance[pos + 1], &s->attendance[pos],
+            (s->attendanceCount - pos) * sizeof(AttendanceRecord));
+
+    strncpy(s->attendance[pos].date, date, sizeof(s->attendance[pos].date) - 1);
+    s->attendance[pos].date[sizeof(s->attendance[pos].date) - 1] = 0;
+    s->attendance[pos].day = day;
+    strncpy(s->attendance[pos].status, status, sizeof(s->attendance[pos].status) - 1);
+    s->attendance[pos].status[sizeof(s->attendance[pos].status) - 1] = 0;
+    s->attendance[pos].saved = 0;
+
+    s->attendanceCount++;
+    if (strcmp(status, "Present") == 0) {
+        s->presentCount++;
     }
+    updateStreak(s, pos);
+    dataVersion++;
+    return pos;
+}
 
-    // Write CSV Header
-    fprintf(fp, "ID,Name,Date,Status\n");
+// Keeps the trailing absence run current. A record inserted before the run
+// leaves it alone; inside it, an absence extends it and a presence cuts it
+// down to the records after pos.
+void updateStreak(Student *s, int pos) {
+    int oldCount = s->attendanceCount - 1;
+    if (pos < oldCount - s->absentStreak) {
+        return;
+    }
+    if (strcmp(s->attendance[pos].status, "Present") == 0) {
+        s->absentStreak = oldCount - pos;
+    } else {
+        s->absentStreak++;
+    }
+}
 
-    for (int i = 0; i < studentCount; i++) {
-        // If student has no attendance, save just their info
-        if (students[i].attendanceCount == 0) {
-            fprintf(fp, "%s,%s,None,None\n", students[i].id, students[i].name);
+// Binary search: first record on or after day (or after it when upper is set).
+// Records with an invalid date sort first.
+int findRecordBound(AttendanceRecord *records, int count, int day, int upper) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (records[mid].day < day || (upper && records[mid].day == day)) {
+            lo = mid + 1;
         } else {
-            // If student has attendance, save a row for every record
-            for (int j = 0; j < students[i].attendanceCount; j++) {
-                fprintf(fp, "%s,%s,%s,%s\n", 
-                    students[i].id, 
-                    students[i].name, 
-                    students[i].attendance[i].date, 
-                    students[i].attendance[j].date, 
-                    students[i].attendance[j].status);
-            }
+            hi = mid;
         }
     }
+    return lo;
+}
 
-    fclose(fp);
+// Prints records [from, to) of a student
+void printRecordWindow(Student *s, int from, int to) {
+    for (int i = from; i < to; i++) {
+        printf("%4d. %s : %s\n", i + 1, s->attendance[i].date, s->attendance[i].status);
+    }
 }
 
-// Load data from CSV
-void loadData() {
-    FILE *fp = fopen(FILENAME, "r");
-    if (fp == NULL) {
-        // File doesn't exist yet (first run), just return
+// Allocates an empty record block owned by one student
+RecordBlock *newRecordBlock(int capacity) {
+    size_t bytes = sizeof(RecordBlock) + (capacity - 1) * sizeof(AttendanceRecord);
+    RecordBlock *block;
+
+    if (useArena) {
+        block = (RecordBlock *)arenaAlloc(bytes);
+    } else {
+        block = (RecordBlock *)malloc(bytes);
+        allocCount++;
+    }
+    if (block != NULL) {
+        block->refs = 1;
+        block->capacity = capacity;
+    }
+    return block;
+}
+
+// Drops one owner; the last one frees the block (pool blocks wait for resetData)
+void releaseRecordBlock(RecordBlock *block) {
+    if (block != NULL && --block->refs == 0 && !useArena) {
+        free(block);
+    }
+}
+
+// Moves a student's records into a new private block of the given capacity.
+// On failure the student keeps the old block.
+void detachRecords(Student *s, int capacity) {
+    RecordBlock *block = newRecordBlock(capacity);
+    if (block == NULL) {
+        printf("Error: Out of memory!\n");
         return;
     }
 
-    char line[256];
-    // Skip the header line
-    fgets(line, sizeof(line), fp);
+    if (s->attendanceCount > 0) {
+        memcpy(block->records, s->attendance, s->attendanceCount * sizeof(AttendanceRecord));
+    }
+    releaseRecordBlock(s->block);
+    s->block = block;
+    s->attendance = block->records;
+}
 
-    while (fgets(line, sizeof(line), fp)) {
-        // Remove newline character
-        line[strcspn(line, "\n")] = 0;
+// === END ATTENDANCE RECORDS ===
 
-        char *id = strtok(line, ",");
-        char *name = strtok(NULL, ",");
-        char *date = strtok(NULL, ",");
-        char *status = strtok(NULL, ",");
+// === SNAPSHOTS ===
 
-        if (id && name && date && status) {
-            // Check if student already exists in our RAM array
-            int index = findStudentIndex(id);
+// Captures the current student table. Later marks do not change what the
+// snapshot sees, and the snapshot never blocks them.
+Snapshot *takeSnapshot() {
+    Snapshot *snap = (Snapshot *)malloc(sizeof(Snapshot));
+    if (snap == NULL) {
+        return NULL;
+    }
+    snap->views = (StudentView *)malloc((studentCount > 0 ? studentCount : 1) * sizeof(StudentView));
+    if (snap->views == NULL) {
+        free(snap);
+        return NULL;
+    }
 
-            if (index == -1) {
-                // New student found in file, add to array
-                if (studentCount < MAX_STUDENTS) {
-                    strcpy(students[studentCount].id, id);
-                    strcpy(students[studentCount].name, name);
-                    students[studentCount].attendanceCount = 0;
-                    index = studentCount;
-                    studentCount++;
-                }
-            }
+    snap->version = dataVersion;
+    snap->count = studentCount;
+    liveSnapshots++;
+    for (int i = 0; i < studentCount; i++) {
+        StudentView *v = &snap->views[i];
+        v->student = &students[idIndex[i]];  // views are in ID order
+        v->block = students[idIndex[i]].block;
+        v->recordCount = students[idIndex[i]].attendanceCount;
+        v->presentCount = students[idIndex[i]].presentCount;
+        v->unloadedCount = students[idIndex[i]].unloadedCount;
+        v->unloadedPresent = students[idIndex[i]].unloadedPresent;
+        if (v->block != NULL) {
+            v->block->refs++;
+        }
+    }
+    return snap;
+}
+
+// Releases a snapshot and any record blocks only it was still holding
+void releaseSnapshot(Snapshot *snap) {
+    if (snap == NULL) {
+        return;
+    }
+    for (int i = 0; i < snap->count; i++) {
+        releaseRecordBlock(snap->views[i].block);
+    }
+    free(snap->views);
+    free(snap);
+    liveSnapshots--;
+}
+
+// Writes per-student totals for days fromDay..toDay as CSV; DAY_INVALID..DAY_MAX
+// covers everything. A range assumes the older records it reaches are loaded.
+// Returns the number of students written, or -1.
+int writeReport(Snapshot *snap, int fromDay, int toDay, const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        printf("Error: Could not write '%s'!\n", path);
+        return -1;
+    }
 
-            // If the record is not "None", add the attendance
-            if (strcmp(date, "None") != 0 && index != -1) {
-                int ac = students[index].attendanceCount;
-                if (ac < MAX_RECORDS) {
-                    strcpy(students[index].attendance[ac].date, date);
-                    strcpy(students[index].attendance[ac].status, status);
-                    students[index].attendanceCount++;
+    fprintf(fp, "ID,Name,Total,Present,Absent,Percentage\n");
+
+    for (int i = 0; i < snap->count; i++) {
+        StudentView *v = &snap->views[i];
+        int total = v->recordCount + v->unloadedCount;
+        int present = v->presentCount + v->unloadedPresent;
+
+        // Date filters count only the loaded records in range; unloaded ones
+        // are all before historyCutoff, which the caller loads when needed
+        if (fromDay != DAY_INVALID || toDay != DAY_MAX) {
+            AttendanceRecord *records = v->block != NULL ? v->block->records : NULL;
+            int first = findRecordBound(records, v->recordCount, fromDay, 0);
+            int last = findRecordBound(records, v->recordCount, toDay, 1);
+
+            total = last > first ? last - first : 0;
+            present = 0;
+            for (int j = first; j < last; j++) {
+                if (strcmp(records[j].status, "Present") == 0) {
+                    present++;
                 }
             }
         }
+
+        fprintf(fp, "%s,%s,%d,%d,%d,%.1f\n", v->student->id, v->student->name,
+                total, present, total - present, total > 0 ? 100.0 * present / total : 0.0);
     }
 
     fclose(fp);
+    return snap->count;
 }
 
-// === END FILE OPERATIONS ===
+// === END SNAPSHOTS ===
 
 // Add a new student
 void addStudent() {
@@ -191,29 +2423,40 @@ void addStudent() {
         return;
     }
 
-    Student newStudent;
+    char name[MAX_NAME], id[MAX_ID];
 
     printf("\n====== ADD NEW STUDENT ======\n");
 
     printf("Enter Student Name: ");
-    fgets(newStudent.name, MAX_NAME, stdin);
-    newStudent.name[strcspn(newStudent.name, "\n")] = 0;
+    fgets(name, MAX_NAME, stdin);
+    name[strcspn(name, "\n")] = 0;
 
     printf("Enter Student ID: ");
-    fgets(newStudent.id, MAX_ID, stdin);
-    newStudent.id[strcspn(newStudent.id, "\n")] = 0;
+    fgets(id, MAX_ID, stdin);
+    id[strcspn(id, "\n")] = 0;
+
+    // A comma would split the name into another CSV column
+    if (name[0] == 0 || strchr(name, ',') != NULL) {
+        printf("Error: Name must not be empty or contain commas!\n");
+        pauseProgram();
+        return;
+    }
+
+    if (!isValidStudentId(id)) {
+        printf("Error: Invalid ID format! Expected e.g. BSE-25F-086\n");
+        pauseProgram();
+        return;
+    }
 
     // Check if ID already exists
-    if (findStudentIndex(newStudent.id) != -1) {
+    if (findStudentIndex(id) != -1) {
         printf("Error: Student ID already exists!\n");
         pauseProgram();
         return;
     }
 
-    newStudent.attendanceCount = 0;  // initialize record count
-
     // Add to array
-    students[studentCount++] = newStudent;
+    markDirty(createStudent(id, name));
 
     saveData(); // Auto-save
     printf("\nStudent added and saved successfully!\n");
@@ -232,11 +2475,119 @@ void viewAllStudents() {
         return;
     }
 
-    int i;
-    for (i = 0; i < studentCount; i++) {
-        printf("%d. %s (ID: %s)\n", i + 1, students[i].name, students[i].id);
+    // Listed in ID order
+    printStudentPages(idIndex, 0, studentCount);
+
+    pauseProgram();
+}
+
+// Import a roster file exported by admissions
+void importStudents() {
+    clearScreen();
+
+    char path[256];
+    printf("\n====== IMPORT STUDENT ROSTER ======\n");
+    printf("Roster file (ID,Name per line): ");
+    fgets(path, sizeof(path), stdin);
+    path[strcspn(path, "\n")] = 0;
+
+    clock_t start = clock();
+    int rejected = 0;
+    int added = importRoster(path, &rejected);
+
+    if (added >= 0) {
+        printf("\nImported %d student(s) in %.1f ms.\n", added,
+               1000.0 * (clock() - start) / CLOCKS_PER_SEC);
+        if (rejected > 0) {
+            printf("%d row(s) rejected, see '%s'.\n", rejected, REJECTS_FILE);
+        }
+    }
+
+    pauseProgram();
+}
+
+// Export per-student totals, optionally for a date range
+void attendanceReport() {
+    clearScreen();
+
+    int fromDay, toDay;
+    printf("\n====== ATTENDANCE REPORT ======\n");
+    if (!readDateRange(&fromDay, &toDay)) {
+        pauseProgram();
+        return;
+    }
+
+    // A range reaching back before the current term needs the older records
+    if ((fromDay != DAY_INVALID || toDay != DAY_MAX) && fromDay < historyCutoff) {
+        ensureAllHistory();
+    }
+
+    // The report reads a frozen copy, so marking can go on while it runs
+    Snapshot *snap = takeSnapshot();
+    if (snap == NULL) {
+        printf("Error: Out of memory!\n");
+        pauseProgram();
+        return;
+    }
+
+    int written = writeReport(snap, fromDay, toDay, REPORT_FILE);
+    if (written >= 0) {
+        printf("\nReport of %d student(s) (version %d) written to '%s'.\n",
+               written, snap->version, REPORT_FILE);
+    }
+    releaseSnapshot(snap);
+
+    pauseProgram();
+}
+
+// Search students by ID prefix, name prefix or ID range
+void searchStudents() {
+    clearScreen();
+
+    printf("\n====== SEARCH STUDENTS ======\n");
+
+    if (studentCount == 0) {
+        printf("No students available.\n");
+        pauseProgram();
+        return;
+    }
+
+    int searchChoice;
+    printf("1. By ID prefix (e.g. BSE-25F)\n2. By Name prefix\n3. By ID range\nEnter choice: ");
+    scanf("%d", &searchChoice);
+    getchar();
+
+    char from[MAX_NAME], to[MAX_ID];
+    int first = 0, count = 0;
+    int *index = idIndex;
+
+    if (searchChoice == 1 || searchChoice == 2) {
+        printf("Enter prefix: ");
+        fgets(from, MAX_NAME, stdin);
+        from[strcspn(from, "\n")] = 0;
+
+        if (searchChoice == 2) {
+            index = nameIndex;
+        }
+        count = findPrefixRange(from, searchChoice == 2, &first);
+    } else if (searchChoice == 3) {
+        printf("From ID: ");
+        fgets(from, MAX_ID, stdin);
+        from[strcspn(from, "\n")] = 0;
+        printf("To ID: ");
+        fgets(to, MAX_ID, stdin);
+        to[strcspn(to, "\n")] = 0;
+
+        count = findIdRange(from, to, &first);
+    } else {
+        printf("Invalid choice!\n");
+        pauseProgram();
+        return;
     }
 
+    printf("\n%d student(s) found.\n\n", count);
+    printStudentPages(index, first, count);
+
     pauseProgram();
 }
 
@@ -272,6 +2623,24 @@ void markAttendance() {
     fgets(newRecord.date, 15, stdin);
     newRecord.date[strcspn(newRecord.date, "\n")] = 0;
 
+    newRecord.day = parseDate(newRecord.date);
+    if (newRecord.day == DAY_INVALID) {
+        printf("\nInvalid date! Use a real date as YYYY-MM-DD.\n");
+        pauseProgram();
+        return;
+    }
+
+    // Weekends, holidays and dates outside the term need confirming
+    if (!isClassDay(newRecord.day)) {
+        char answer[8];
+        printf("%s is not a class day. Mark anyway? (y/n): ", newRecord.date);
+        fgets(answer, sizeof(answer), stdin);
+        if (answer[0] != 'y' && answer[0] != 'Y') {
+            pauseProgram();
+            return;
+        }
+    }
+
     int statusChoice;
     printf("1. Present\n2. Absent\nEnter status: ");
     scanf("%d", &statusChoice);
@@ -287,10 +2656,18 @@ void markAttendance() {
         return;
     }
 
-    s->attendance[s->attendanceCount++] = newRecord;
+    if (addRecord(s, newRecord.date, newRecord.status) == -1) {
+        pauseProgram();
+        return;
+    }
+    markDirty(found);
+    evaluateAlerts(found, newRecord.date);
 
     saveData(); // Auto-save
     printf("\nAttendance marked and saved successfully!\n");
+    if (classDayIndex(newRecord.day) != -1) {
+        printf("(Class day %d of the term)\n", classDayIndex(newRecord.day) + 1);
+    }
     
     pauseProgram();
 }
@@ -323,17 +2700,70 @@ void viewStudentAttendance() {
     Student *s = &students[found];
 
     printf("\nName: %s\nID: %s\n", s->name, s->id);
-    printf("\n----- Attendance Records -----\n");
 
-    if (s->attendanceCount == 0) {
-        printf("No attendance marked yet.\n");
+    if (totalRecords(s) == 0) {
+        printf("\nNo attendance marked yet.\n");
         pauseProgram();
         return;
     }
 
-    for (int i = 0; i < s->attendanceCount; i++) {
-        printf("%s : %s\n", s->attendance[i].date, s->attendance[i].status);
-    }
+    // Summary comes from the cached totals, older records need not be loaded
+    int absent = totalRecords(s) - totalPresent(s);
+    printf("Total: %d | Present: %d | Absent: %d | Attendance: %.1f%%\n",
+           totalRecords(s), totalPresent(s), absent,
+           100.0 * totalPresent(s) / totalRecords(s));
 
-    pauseProgram();
+    // Window of records being browsed, starting with the whole history
+    int fromDay = DAY_INVALID, toDay = DAY_MAX;
+    int windowStart = 0, windowEnd = s->attendanceCount;
+    int pageStart = windowEnd - PAGE_SIZE;  // open on the most recent page
+    if (pageStart < windowStart) pageStart = windowStart;
+
+    char command[MAX_ID];
+    do {
+        int pageEnd = pageStart + PAGE_SIZE;
+        if (pageEnd > windowEnd) pageEnd = windowEnd;
+
+        printf("\n----- Attendance Records (%d-%d of %d) -----\n",
+               windowEnd > windowStart ? pageStart - windowStart + 1 : 0,
+               pageEnd - windowStart, windowEnd - windowStart);
+        if (windowEnd == windowStart) {
+            printf("No records in this date range.\n");
+        }
+        printRecordWindow(s, pageStart, pageEnd);
+        int whole = fromDay == DAY_INVALID && toDay == DAY_MAX;
+        if (whole && s->unloadedCount > 0) {
+            printf("(%d older record(s) are loaded when you page back)\n", s->unloadedCount);
+        }
+
+        printf("\n[P]revious  [N]ext  [R]ange  [Q]uit: ");
+        fgets(command, sizeof(command), stdin);
+
+        if (command[0] == 'p' || command[0] == 'P') {
+            // Paging back past the loaded records reads the older ones; a
+            // date range has loaded whatever it needs already
+            if (whole && pageStart == 0 && s->unloadedCount > 0) {
+                pageStart += ensureHistory(s);
+                windowStart = findRecordBound(s->attendance, s->attendanceCount, fromDay, 0);
+                windowEnd = findRecordBound(s->attendance, s->attendanceCount, toDay, 1);
+            }
+            pageStart -= PAGE_SIZE;
+            if (pageStart < windowStart) pageStart = windowStart;
+        } else if (command[0] == 'n' || command[0] == 'N') {
+            if (pageStart + PAGE_SIZE < windowEnd) pageStart += PAGE_SIZE;
+        } else if (command[0] == 'r' || command[0] == 'R') {
+            int newFrom, newTo;
+            if (readDateRange(&newFrom, &newTo)) {
+                fromDay = newFrom;
+                toDay = newTo;
+                if (fromDay < historyCutoff) {
+                    ensureHistory(s);
+                }
+                windowStart = findRecordBound(s->attendance, s->attendanceCount, fromDay, 0);
+                windowEnd = findRecordBound(s->attendance, s->attendanceCount, toDay, 1);
+                if (windowEnd < windowStart) windowEnd = windowStart;
+                pageStart = windowStart;
+            }
+        }
+    } while (command[0] != 'q' && command[0] != 'Q');
 }